@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 Red Hat.
+ *
+ * Drive N concurrent pmcd clients (each with its own connection),
+ * fetching the same metrics repeatedly, and report the distribution
+ * of fetch latencies as seen by the clients.
+ *
+ * Usage: fetchclients [-c clients] [-h host] [-s samples] [-t threads]
+ *		       [-v] metric ...
+ */
+
+#include <pcp/pmapi.h>
+#include <pthread.h>
+#include "libpcp.h"
+
+static int	nclients = 100;		/* -c */
+static int	nthreads = 4;		/* -t */
+static int	nsamples = 100;		/* -s */
+static int	vflag;			/* -v */
+static char	*host = "local:";	/* -h */
+
+static int	nmetrics;
+static pmID	*pmids;
+
+static double	*latency;		/* one entry per fetch, all threads */
+static int	nlatency;
+
+typedef struct {
+    int		first;			/* first client for this thread */
+    int		last;			/* last client + 1 */
+    int		errors;
+} worker_t;
+
+static void *
+worker(void *arg)
+{
+    worker_t		*wp = (worker_t *)arg;
+    struct timeval	before, after;
+    pmResult		*rp;
+    int			*ctx;
+    int			i, n, sts;
+
+    if ((ctx = calloc(wp->last - wp->first, sizeof(int))) == NULL) {
+	wp->errors++;
+	return NULL;
+    }
+    for (i = wp->first; i < wp->last; i++) {
+	if ((sts = pmNewContext(PM_CONTEXT_HOST, host)) < 0) {
+	    fprintf(stderr, "client[%d]: pmNewContext(%s): %s\n",
+			i, host, pmErrStr(sts));
+	    wp->errors++;
+	    ctx[i - wp->first] = -1;
+	    continue;
+	}
+	ctx[i - wp->first] = sts;
+    }
+
+    /* round-robin each sample across all of this thread's clients */
+    for (n = 0; n < nsamples; n++) {
+	for (i = wp->first; i < wp->last; i++) {
+	    if (ctx[i - wp->first] < 0)
+		continue;
+	    pmUseContext(ctx[i - wp->first]);
+	    pmtimevalNow(&before);
+	    sts = pmFetch(nmetrics, pmids, &rp);
+	    pmtimevalNow(&after);
+	    if (sts < 0) {
+		if (vflag)
+		    fprintf(stderr, "client[%d]: pmFetch: %s\n", i, pmErrStr(sts));
+		wp->errors++;
+		continue;
+	    }
+	    pmFreeResult(rp);
+	    latency[n * nclients + i] = pmtimevalSub(&after, &before);
+	}
+    }
+
+    for (i = wp->first; i < wp->last; i++) {
+	if (ctx[i - wp->first] >= 0)
+	    pmDestroyContext(ctx[i - wp->first]);
+    }
+    free(ctx);
+    return NULL;
+}
+
+static int
+compare(const void *a, const void *b)
+{
+    double	x = *(const double *)a;
+    double	y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+static double
+percentile(double pct)
+{
+    int		i = (int)(pct / 100.0 * (nlatency - 1) + 0.5);
+
+    return latency[i];
+}
+
+int
+main(int argc, char **argv)
+{
+    int			c, i, j, sts;
+    int			ctx;
+    int			errflag = 0;
+    int			errors = 0;
+    char		*endnum;
+    double		elapsed, sum;
+    struct timeval	start, end;
+    pthread_t		*tids;
+    worker_t		*work;
+
+    pmSetProgname(argv[0]);
+
+    while ((c = getopt(argc, argv, "c:D:h:s:t:v?")) != EOF) {
+	switch (c) {
+	case 'c':	/* number of clients */
+	    nclients = (int)strtol(optarg, &endnum, 10);
+	    if (*endnum != '\0' || nclients < 1) {
+		fprintf(stderr, "%s: -c requires positive numeric argument\n", pmGetProgname());
+		errflag++;
+	    }
+	    break;
+
+	case 'D':	/* debug options */
+	    if ((sts = pmSetDebug(optarg)) < 0) {
+		fprintf(stderr, "%s: unrecognized debug options specification (%s)\n",
+		    pmGetProgname(), optarg);
+		errflag++;
+	    }
+	    break;
+
+	case 'h':	/* contact PMCD on this hostname */
+	    host = optarg;
+	    break;
+
+	case 's':	/* samples per client */
+	    nsamples = (int)strtol(optarg, &endnum, 10);
+	    if (*endnum != '\0' || nsamples < 1) {
+		fprintf(stderr, "%s: -s requires positive numeric argument\n", pmGetProgname());
+		errflag++;
+	    }
+	    break;
+
+	case 't':	/* number of threads */
+	    nthreads = (int)strtol(optarg, &endnum, 10);
+	    if (*endnum != '\0' || nthreads < 1) {
+		fprintf(stderr, "%s: -t requires positive numeric argument\n", pmGetProgname());
+		errflag++;
+	    }
+	    break;
+
+	case 'v':	/* verbose */
+	    vflag++;
+	    break;
+
+	case '?':
+	default:
+	    errflag++;
+	    break;
+	}
+    }
+
+    if (errflag || optind == argc) {
+	fprintf(stderr, "Usage: %s [-c clients] [-D debug] [-h host] [-s samples] [-t threads] [-v] metric ...\n", pmGetProgname());
+	exit(1);
+    }
+    if (nthreads > nclients)
+	nthreads = nclients;
+
+    /* resolve metric names once, using a throwaway context */
+    if ((ctx = pmNewContext(PM_CONTEXT_HOST, host)) < 0) {
+	fprintf(stderr, "%s: pmNewContext(%s): %s\n", pmGetProgname(), host, pmErrStr(ctx));
+	exit(1);
+    }
+    nmetrics = argc - optind;
+    if ((pmids = malloc(nmetrics * sizeof(pmID))) == NULL) {
+	pmNoMem("pmids", nmetrics * sizeof(pmID), PM_FATAL_ERR);
+	/* NOTREACHED */
+    }
+    if ((sts = pmLookupName(nmetrics, (const char **)&argv[optind], pmids)) < 0) {
+	fprintf(stderr, "%s: pmLookupName: %s\n", pmGetProgname(), pmErrStr(sts));
+	exit(1);
+    }
+    pmDestroyContext(ctx);
+
+    nlatency = nclients * nsamples;
+    latency = (double *)calloc(nlatency, sizeof(double));
+    tids = (pthread_t *)calloc(nthreads, sizeof(pthread_t));
+    work = (worker_t *)calloc(nthreads, sizeof(worker_t));
+    if (latency == NULL || tids == NULL || work == NULL) {
+	pmNoMem("fetchclients", nlatency * sizeof(double), PM_FATAL_ERR);
+	/* NOTREACHED */
+    }
+    for (i = 0; i < nlatency; i++)
+	latency[i] = -1;
+
+    pmtimevalNow(&start);
+    for (i = j = 0; i < nthreads; i++) {
+	work[i].first = j;
+	j += nclients / nthreads + (i < nclients % nthreads);
+	work[i].last = j;
+	if ((sts = pthread_create(&tids[i], NULL, worker, &work[i])) != 0) {
+	    fprintf(stderr, "%s: pthread_create: %s\n", pmGetProgname(), strerror(sts));
+	    exit(1);
+	}
+    }
+    for (i = 0; i < nthreads; i++) {
+	pthread_join(tids[i], NULL);
+	errors += work[i].errors;
+    }
+    pmtimevalNow(&end);
+    elapsed = pmtimevalSub(&end, &start);
+
+    /* discard failed fetches, then summarise */
+    for (i = j = 0; i < nlatency; i++) {
+	if (latency[i] >= 0)
+	    latency[j++] = latency[i];
+    }
+    nlatency = j;
+    if (nlatency == 0) {
+	fprintf(stderr, "%s: no successful fetches (%d errors)\n", pmGetProgname(), errors);
+	exit(1);
+    }
+    qsort(latency, nlatency, sizeof(double), compare);
+    for (i = 0, sum = 0; i < nlatency; i++)
+	sum += latency[i];
+
+    printf("clients: %d threads: %d metrics: %d fetches: %d errors: %d\n",
+	    nclients, nthreads, nmetrics, nlatency, errors);
+    printf("elapsed: %.3f sec throughput: %.1f fetch/sec\n",
+	    elapsed, nlatency / elapsed);
+    printf("latency (msec): min %.3f mean %.3f p50 %.3f p90 %.3f p99 %.3f p99.9 %.3f max %.3f\n",
+	    latency[0] * 1000, sum / nlatency * 1000,
+	    percentile(50) * 1000, percentile(90) * 1000,
+	    percentile(99) * 1000, percentile(99.9) * 1000,
+	    latency[nlatency-1] * 1000);
+
+    return errors != 0;
+}
@@ -70,6 +70,7 @@ CleanupAgent(AgentInfo* aPtr, int why, int status)
     }
     else {
 	pmcd_trace(TR_DEL_AGENT, aPtr->pmDomainId, aPtr->inFd, aPtr->outFd);
+	IOEventDel(aPtr->outFd);
 	if (aPtr->inFd != -1) {
 	    if (aPtr->ipcType == AGENT_SOCKET)
 	      __pmCloseSocket(aPtr->inFd);
@@ -19,9 +19,6 @@
 
 #define MIN_CLIENTS_ALLOC 8
 
-int		maxClientFd = -1;	/* largest fd for a client */
-__pmFdSet	clientFds;		/* for client select() */
-
 static int	clientSize;
 
 /*
@@ -103,12 +100,15 @@ AcceptNewClient(int reqfd)
 	DeleteClient(&client[i]);
 	return NULL;	
     }
-    if (fd > maxClientFd)
-	maxClientFd = fd;
+    if (IOEventAdd(fd, IO_CLIENT, i) < 0) {
+	__pmCloseSocket(fd);
+	client[i].fd = -1;
+	DeleteClient(&client[i]);
+	return NULL;
+    }
 
     pmcd_openfds_sethi(fd);
 
-    __pmFD_SET(fd, &clientFds);
     __pmSetVersionIPC(fd, UNKNOWN_VERSION);	/* before negotiation */
     __pmSetSocketIPC(fd);
 
@@ -188,7 +188,7 @@ DeleteClient(ClientInfo *cp)
 	return;
     }
     if (cp->fd != -1) {
-	__pmFD_CLR(cp->fd, &clientFds);
+	IOEventDel(cp->fd);
 	__pmCloseSocket(cp->fd);
     }
     if (i == nClients-1) {
@@ -197,13 +197,6 @@ DeleteClient(ClientInfo *cp)
 	    i--;
 	nClients = (i >= 0) ? i + 1 : 0;
     }
-    if (cp->fd == maxClientFd) {
-	maxClientFd = -1;
-	for (i = 0; i < nClients; i++) {
-	    if (client[i].fd > maxClientFd)
-		maxClientFd = client[i].fd;
-	}
-    }
     hcp = &cp->profile;
     for (i = 0; i < hcp->hsize; i++) {
 	for (hp = hcp->hash[i]; hp != NULL; hp = hp->next) {
@@ -386,6 +386,31 @@ ExtractState(int i, void *timestamp)
     return (int)byte;
 }
 
+/*
+ * Account for the time agent ap took to respond to a fetch request
+ * that was sent at time "sent" - for the pmcd.agent.fetch metrics.
+ */
+static void
+FetchLatency(AgentInfo *ap, struct timeval *sent)
+{
+    static const double	bounds[FETCH_BUCKETS-1] = {
+	0.0001, 0.001, 0.01, 0.1, 1.0		/* seconds */
+    };
+    struct timeval	now;
+    double		elapsed;
+    int			b;
+
+    pmtimevalNow(&now);
+    elapsed = pmtimevalSub(&now, sent);
+    for (b = 0; b < FETCH_BUCKETS-1; b++) {
+	if (elapsed < bounds[b])
+	    break;
+    }
+    ap->fetch.count++;
+    ap->fetch.time += (__uint64_t)(elapsed * 1000000);
+    ap->fetch.hist[b]++;
+}
+
 /*
  * Handle both the original and high resolution fetch PDU requests.
  * The input handling and PMDA interactions are the same, difference
@@ -397,6 +422,7 @@ HandleFetch(ClientInfo *cip, __pmPDU* pb, int pdutype)
 {
     int			i, j;
     int 		sts;
+    int			dso;
     int			ctxnum;
     unsigned int	changes = 0;
     int			nPmids;
@@ -407,6 +433,7 @@ HandleFetch(ClientInfo *cip, __pmPDU* pb, int pdutype)
     static int		nDoms;
     static pmResult	**results;	/* array of replies from PMDAs */
     static int		*resIndex;
+    static struct timeval *sent;	/* when each agent was sent a request */
     __pmFdSet		waitFds;
     __pmFdSet		readyFds;
     int			nWait;
@@ -421,10 +448,13 @@ HandleFetch(ClientInfo *cip, __pmPDU* pb, int pdutype)
 	    free(results);
 	if (resIndex != NULL)
 	    free(resIndex);
+	if (sent != NULL)
+	    free(sent);
 	results = (pmResult **)malloc((nAgents + 1) * sizeof (pmResult *));
 	resIndex = (int *)malloc((nAgents + 1) * sizeof(int));
-	if (results == NULL || resIndex == NULL) {
-	    pmNoMem("DoFetch.results", (nAgents + 1) * sizeof (pmResult *) + (nAgents + 1) * sizeof(int), PM_FATAL_ERR);
+	sent = (struct timeval *)malloc(nAgents * sizeof(struct timeval));
+	if (results == NULL || resIndex == NULL || sent == NULL) {
+	    pmNoMem("DoFetch.results", (nAgents + 1) * sizeof (pmResult *) + (nAgents + 1) * sizeof(int) + nAgents * sizeof(struct timeval), PM_FATAL_ERR);
 	    /* NOTREACHED */
 	}
 	nDoms = nAgents;
@@ -468,26 +498,36 @@ HandleFetch(ClientInfo *cip, __pmPDU* pb, int pdutype)
     dList = SplitPmidList(nPmids, pmidList);
 
     /* For each domain in the split pmidList, dispatch the per-domain subset
-     * of pmIDs to the appropriate agent.  For DSO agents, the pmResult will
-     * come back immediately.  If a request cannot be sent to an agent, a
-     * suitable pmResult (containing metric not available values) will be
-     * returned.
+     * of pmIDs to the appropriate agent.  Requests are sent to all of the
+     * daemon (socket and pipe) agents first so that they work concurrently,
+     * then the DSO agents are called while the daemons are busy - for DSO
+     * agents the pmResult comes back immediately.  Total latency is thus
+     * that of the slowest agent, rather than the sum over all agents.
+     * If a request cannot be sent to an agent, a suitable pmResult
+     * (containing metric not available values) will be returned.
      */
     __pmFD_ZERO(&waitFds);
     nWait = 0;
     maxFd = -1;
-    for (i = 0; dList[i].domain != -1; i++) {
-	j = mapdom[dList[i].domain];
-	results[j] = SendFetch(&dList[i], &agent[j], cip, ctxnum);
-	if (results[j] == NULL) { /* Wait for agent's response */
-	    int fd = agent[j].outFd;
-	    agent[j].status.busy = 1;
-	    __pmFD_SET(fd, &waitFds);
-	    if (fd > maxFd)
-		maxFd = fd;
-	    nWait++;
-	} else {
-	    changes |= ExtractState(i, &results[j]->timestamp);
+    for (dso = 0; dso < 2; dso++) {
+	for (i = 0; dList[i].domain != -1; i++) {
+	    j = mapdom[dList[i].domain];
+	    if ((agent[j].ipcType == AGENT_DSO) != dso)
+		continue;
+	    pmtimevalNow(&sent[j]);
+	    results[j] = SendFetch(&dList[i], &agent[j], cip, ctxnum);
+	    if (results[j] == NULL) { /* Wait for agent's response */
+		int fd = agent[j].outFd;
+		agent[j].status.busy = 1;
+		__pmFD_SET(fd, &waitFds);
+		if (fd > maxFd)
+		    maxFd = fd;
+		nWait++;
+	    } else {
+		if (dso && agent[j].status.connected)
+		    FetchLatency(&agent[j], &sent[j]);
+		changes |= ExtractState(j, &results[j]->timestamp);
+	    }
 	}
     }
     /* Construct pmResult for bad-pmID list */
@@ -519,6 +559,7 @@ HandleFetch(ClientInfo *cip, __pmPDU* pb, int pdutype)
 						   dList[j].list,
 						   PM_ERR_NOAGENT);
 			pmcd_trace(TR_RECV_TIMEOUT, agent[i].outFd, PDU_RESULT, 0);
+			FetchLatency(&agent[i], &sent[i]);
 			CleanupAgent(&agent[i], AT_COMM, agent[i].inFd);
 		    }
 		}
@@ -545,6 +586,7 @@ HandleFetch(ClientInfo *cip, __pmPDU* pb, int pdutype)
 	    __pmFD_CLR(ap->outFd, &waitFds);
 	    nWait--;
 	    pinpdu = sts = __pmGetPDU(ap->outFd, ANY_SIZE, pmcd_timeout, &pb);
+	    FetchLatency(ap, &sent[i]);
 	    if (sts > 0)
 		pmcd_trace(TR_RECV_PDU, ap->outFd, sts, (int)((__psint_t)pb & 0xffffffff));
 	    if (sts == PDU_RESULT) {
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 Red Hat.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * for more details.
+ *
+ * Readiness notification for the main pmcd loop.
+ *
+ * ClientLoop() registers each file descriptor it is interested in
+ * (request ports, clients, not-ready agents) once, and IOEventWait()
+ * returns only those descriptors that are ready for reading.  On
+ * platforms with epoll(7) the kernel tracks the interest set, so the
+ * cost of each wakeup is proportional to the number of ready
+ * descriptors rather than the number of connected clients, and the
+ * FD_SETSIZE limit no longer applies.  Elsewhere (or if epoll cannot
+ * be initialised) we fall back to select(2) over an __pmFdSet.
+ */
+
+#include "pmcd.h"
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#endif
+
+#define MIN_EVENTS_ALLOC 64
+
+typedef struct {
+    int		type;		/* IO_* or zero if unused */
+    int		index;		/* client[] or agent[] index */
+} ioslot_t;
+
+static ioslot_t	*slots;		/* descriptor-indexed registrations */
+static int	nslots;
+static IOEvent	*events;	/* ready descriptors from last wait */
+static int	nevents;
+static int	nregistered;
+
+static int	use_epoll;
+#ifdef HAVE_SYS_EPOLL_H
+static int		epollfd = -1;
+static struct epoll_event *epevents;
+#endif
+static __pmFdSet	readfds;	/* select(2) fallback interest set */
+static int		maxfd = -1;
+
+static int
+grow_slots(int fd)
+{
+    ioslot_t	*tmp;
+    int		size = nslots ? nslots : MIN_EVENTS_ALLOC;
+
+    while (size <= fd)
+	size *= 2;
+    if ((tmp = realloc(slots, size * sizeof(ioslot_t))) == NULL) {
+	pmNoMem("IOEvent slots", size * sizeof(ioslot_t), PM_RECOV_ERR);
+	return -ENOMEM;
+    }
+    memset(&tmp[nslots], 0, (size - nslots) * sizeof(ioslot_t));
+    slots = tmp;
+    nslots = size;
+    return 0;
+}
+
+static int
+grow_events(void)
+{
+    IOEvent	*tmp;
+    int		size = nevents ? nevents : MIN_EVENTS_ALLOC;
+
+    while (size < nregistered)
+	size *= 2;
+    if (size == nevents)
+	return 0;
+    if ((tmp = realloc(events, size * sizeof(IOEvent))) == NULL) {
+	pmNoMem("IOEvent events", size * sizeof(IOEvent), PM_RECOV_ERR);
+	return -ENOMEM;
+    }
+    events = tmp;
+#ifdef HAVE_SYS_EPOLL_H
+    if (use_epoll) {
+	struct epoll_event	*eptmp;
+
+	if ((eptmp = realloc(epevents, size * sizeof(*eptmp))) == NULL) {
+	    pmNoMem("IOEvent epoll", size * sizeof(*eptmp), PM_RECOV_ERR);
+	    return -ENOMEM;
+	}
+	epevents = eptmp;
+    }
+#endif
+    nevents = size;
+    return 0;
+}
+
+int
+IOEventInit(void)
+{
+    __pmFD_ZERO(&readfds);
+    maxfd = -1;
+#ifdef HAVE_SYS_EPOLL_H
+    if ((epollfd = epoll_create1(EPOLL_CLOEXEC)) >= 0)
+	use_epoll = 1;
+    else
+	pmNotifyErr(LOG_WARNING, "IOEventInit: epoll_create1 failed: %s,"
+			" falling back to select\n", osstrerror());
+#endif
+    if (pmDebugOptions.appl3)
+	fprintf(stderr, "IOEventInit: using %s backend\n", IOEventBackend());
+    return grow_events();
+}
+
+const char *
+IOEventBackend(void)
+{
+    return use_epoll ? "epoll" : "select";
+}
+
+/*
+ * Register interest in input on a descriptor.  Re-registering the
+ * same descriptor simply updates its type and index.
+ */
+int
+IOEventAdd(int fd, int type, int index)
+{
+    int		sts, added;
+
+    if (fd < 0)
+	return -EBADF;
+    if (fd >= nslots && (sts = grow_slots(fd)) < 0)
+	return sts;
+    added = (slots[fd].type == 0);
+
+#ifdef HAVE_SYS_EPOLL_H
+    if (use_epoll && added) {
+	struct epoll_event	ev;
+
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.fd = fd;
+	if (epoll_ctl(epollfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+	    /* stale kernel registration from a recycled descriptor */
+	    if (oserror() != EEXIST ||
+		epoll_ctl(epollfd, EPOLL_CTL_MOD, fd, &ev) < 0) {
+		sts = -oserror();
+		pmNotifyErr(LOG_ERR, "IOEventAdd: epoll_ctl(%d): %s\n",
+				fd, pmErrStr(sts));
+		return sts;
+	    }
+	}
+    }
+#endif
+    if (!use_epoll) {
+	if (fd >= FD_SETSIZE) {
+	    pmNotifyErr(LOG_ERR, "IOEventAdd: fd %d exceeds FD_SETSIZE (%d)\n",
+			    fd, FD_SETSIZE);
+	    return -EMFILE;
+	}
+	__pmFD_SET(fd, &readfds);
+	if (fd > maxfd)
+	    maxfd = fd;
+    }
+
+    slots[fd].type = type;
+    slots[fd].index = index;
+    if (added) {
+	nregistered++;
+	if ((sts = grow_events()) < 0)
+	    return sts;
+    }
+    return 0;
+}
+
+/*
+ * Drop interest in a descriptor - must be called before it is closed,
+ * so that a recycled descriptor number cannot be confused with it.
+ */
+void
+IOEventDel(int fd)
+{
+    if (fd < 0 || fd >= nslots || slots[fd].type == 0)
+	return;
+#ifdef HAVE_SYS_EPOLL_H
+    if (use_epoll)
+	(void)epoll_ctl(epollfd, EPOLL_CTL_DEL, fd, NULL);
+#endif
+    slots[fd].type = 0;
+    slots[fd].index = 0;
+    nregistered--;
+    if (!use_epoll) {
+	__pmFD_CLR(fd, &readfds);
+	while (maxfd >= 0 && slots[maxfd].type == 0)
+	    maxfd--;
+    }
+}
+
+/*
+ * Return the registration type for a descriptor, and optionally its
+ * index, or zero if the descriptor is not registered.
+ */
+int
+IOEventType(int fd, int *index)
+{
+    if (fd < 0 || fd >= nslots)
+	return 0;
+    if (index)
+	*index = slots[fd].index;
+    return slots[fd].type;
+}
+
+/*
+ * Block until at least one registered descriptor is ready for reading
+ * (or a signal arrives).  Returns the number of ready descriptors, with
+ * their details in the array returned via readyp, or -1 with errno set.
+ */
+int
+IOEventWait(IOEvent **readyp)
+{
+    int		i, n, fd, count = 0;
+
+#ifdef HAVE_SYS_EPOLL_H
+    if (use_epoll) {
+	if ((n = epoll_wait(epollfd, epevents, nevents, -1)) < 0)
+	    return -1;
+	for (i = 0; i < n; i++) {
+	    fd = epevents[i].data.fd;
+	    if (fd >= nslots || slots[fd].type == 0)
+		continue;
+	    events[count].fd = fd;
+	    events[count].type = slots[fd].type;
+	    events[count].index = slots[fd].index;
+	    count++;
+	}
+	*readyp = events;
+	return count;
+    }
+#endif
+    {
+	__pmFdSet	ready = readfds;
+
+	if ((n = __pmSelectRead(maxfd + 1, &ready, NULL)) < 0)
+	    return -1;
+	for (fd = 0; fd <= maxfd && count < n; fd++) {
+	    if (!__pmFD_ISSET(fd, &ready))
+		continue;
+	    events[count].fd = fd;
+	    events[count].type = slots[fd].type;
+	    events[count].index = slots[fd].index;
+	    count++;
+	}
+    }
+    *readyp = events;
+    return count;
+}
@@ -46,7 +46,6 @@ int		AgentPendingRestart;	/* for automatic restart */
 int		labelChanged;		/* For SIGHUP labels check */
 static int	timeToDie;		/* For SIGINT handling */
 static int	restart;		/* For SIGHUP restart */
-static int	maxReqPortFd;		/* Largest request port fd */
 static char	configFileName[MAXPATHLEN]; /* path to pmcd.conf */
 static char	*logfile = "pmcd.log";	/* log file name */
 static int	run_daemon = 1;		/* run as a daemon, see -f */
@@ -350,154 +349,147 @@ hostname_changed(void)
 }
 
 /*
- * Determine which clients (if any) have sent data to the server and handle it
- * as required.
+ * Handle the data a client (known to be ready for reading) has sent
+ * to the server as required.
  */
-void
-HandleClientInput(__pmFdSet *fdsPtr)
+static void
+HandleClientInput(int i)
 {
     int		sts;
-    int		i;
+    int		pinpdu;
     __pmPDU	*pb;
     __pmPDUHdr	*php;
     ClientInfo	*cp;
 
-    for (i = 0; i < nClients; i++) {
-	int		pinpdu;
-
-	if (!client[i].status.connected || !__pmFD_ISSET(client[i].fd, fdsPtr))
-	    continue;
-
-	cp = &client[i];
-	this_client_id = i;
+    cp = &client[i];
+    this_client_id = i;
 
-	pinpdu = sts = __pmGetPDU(cp->fd, LIMIT_SIZE, pmcd_timeout, &pb);
-	if (sts > 0) {
-	    pmcd_trace(TR_RECV_PDU, cp->fd, sts, (int)((__psint_t)pb & 0xffffffff));
-	} else {
-	    CleanupClient(cp, sts);
-	    continue;
-	}
+    pinpdu = sts = __pmGetPDU(cp->fd, LIMIT_SIZE, pmcd_timeout, &pb);
+    if (sts > 0) {
+	pmcd_trace(TR_RECV_PDU, cp->fd, sts, (int)((__psint_t)pb & 0xffffffff));
+    } else {
+	CleanupClient(cp, sts);
+	return;
+    }
 
-	php = (__pmPDUHdr *)pb;
-	if (__pmVersionIPC(cp->fd) == UNKNOWN_VERSION && php->type != PDU_CREDS) {
-	    /* old V1 client protocol, no longer supported */
-	    sts = PM_ERR_IPC;
-	    CleanupClient(cp, sts);
-	    __pmUnpinPDUBuf(pb);
-	    continue;
-	}
+    php = (__pmPDUHdr *)pb;
+    if (__pmVersionIPC(cp->fd) == UNKNOWN_VERSION && php->type != PDU_CREDS) {
+	/* old V1 client protocol, no longer supported */
+	sts = PM_ERR_IPC;
+	CleanupClient(cp, sts);
+	__pmUnpinPDUBuf(pb);
+	return;
+    }
 
-	if (pmDebugOptions.appl3)
-	    ShowClients(stderr);
+    if (pmDebugOptions.appl3)
+	ShowClients(stderr);
 
-	switch (php->type) {
-	    case PDU_PROFILE:
-		if (hostname_changed()) {
-		    sts = 0;
-		    break;
-		}
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoProfile(cp, pb);
+    switch (php->type) {
+	case PDU_PROFILE:
+	    if (hostname_changed()) {
+		sts = 0;
 		break;
+	    }
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoProfile(cp, pb);
+	    break;
 
-	    case PDU_FETCH:
-		if (hostname_changed()) {
-		    sts = 0;
-		    break;
-		}
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoFetch(cp, pb);
+	case PDU_FETCH:
+	    if (hostname_changed()) {
+		sts = 0;
 		break;
+	    }
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoFetch(cp, pb);
+	    break;
 
-	    case PDU_HIGHRES_FETCH:
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoHighResFetch(cp, pb);
-		break;
+	case PDU_HIGHRES_FETCH:
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoHighResFetch(cp, pb);
+	    break;
 
-	    case PDU_INSTANCE_REQ:
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoInstance(cp, pb);
-		break;
+	case PDU_INSTANCE_REQ:
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoInstance(cp, pb);
+	    break;
 
-	    case PDU_LABEL_REQ:
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoLabel(cp, pb);
-		break;
+	case PDU_LABEL_REQ:
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoLabel(cp, pb);
+	    break;
 
-	    case PDU_DESC_REQ:
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoDesc(cp, pb);
-		break;
+	case PDU_DESC_REQ:
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoDesc(cp, pb);
+	    break;
 
-	    case PDU_DESC_IDS:
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoDescIDs(cp, pb);
-		break;
+	case PDU_DESC_IDS:
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoDescIDs(cp, pb);
+	    break;
 
-	    case PDU_TEXT_REQ:
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoText(cp, pb);
-		break;
+	case PDU_TEXT_REQ:
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoText(cp, pb);
+	    break;
 
-	    case PDU_RESULT:
-		sts = (cp->denyOps & PMCD_OP_STORE) ?
-		      PM_ERR_PERMISSION : DoStore(cp, pb);
-		break;
+	case PDU_RESULT:
+	    sts = (cp->denyOps & PMCD_OP_STORE) ?
+		  PM_ERR_PERMISSION : DoStore(cp, pb);
+	    break;
 
-	    case PDU_PMNS_IDS:
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoPMNSIDs(cp, pb);
-		break;
+	case PDU_PMNS_IDS:
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoPMNSIDs(cp, pb);
+	    break;
 
-	    case PDU_PMNS_NAMES:
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoPMNSNames(cp, pb);
-		break;
+	case PDU_PMNS_NAMES:
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoPMNSNames(cp, pb);
+	    break;
 
-	    case PDU_PMNS_CHILD:
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoPMNSChild(cp, pb);
-		break;
+	case PDU_PMNS_CHILD:
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoPMNSChild(cp, pb);
+	    break;
 
-	    case PDU_PMNS_TRAVERSE:
-		sts = (cp->denyOps & PMCD_OP_FETCH) ?
-		      PM_ERR_PERMISSION : DoPMNSTraverse(cp, pb);
-		break;
+	case PDU_PMNS_TRAVERSE:
+	    sts = (cp->denyOps & PMCD_OP_FETCH) ?
+		  PM_ERR_PERMISSION : DoPMNSTraverse(cp, pb);
+	    break;
 
-	    case PDU_CREDS:
-		sts = DoCreds(cp, pb);
-		break;
+	case PDU_CREDS:
+	    sts = DoCreds(cp, pb);
+	    break;
 
-	    default:
-		sts = PM_ERR_IPC;
-	}
-	if (sts < 0) {
-	    if (pmDebugOptions.appl0)
-		fprintf(stderr, "PDU:  %s client[%d]: %s\n",
-		    __pmPDUTypeStr(php->type), i, pmErrStr(sts));
-	    /* Make sure client still alive before sending. */
-	    if (cp->status.connected) {
-		pmcd_trace(TR_XMIT_PDU, cp->fd, PDU_ERROR, sts);
-		sts = __pmSendError(cp->fd, FROM_ANON, sts);
-		if (sts < 0)
-		    pmNotifyErr(LOG_ERR, "HandleClientInput: "
-			"error sending Error PDU to client[%d] %s\n", i, pmErrStr(sts));
-	    }
+	default:
+	    sts = PM_ERR_IPC;
+    }
+    if (sts < 0) {
+	if (pmDebugOptions.appl0)
+	    fprintf(stderr, "PDU:  %s client[%d]: %s\n",
+		__pmPDUTypeStr(php->type), i, pmErrStr(sts));
+	/* Make sure client still alive before sending. */
+	if (cp->status.connected) {
+	    pmcd_trace(TR_XMIT_PDU, cp->fd, PDU_ERROR, sts);
+	    sts = __pmSendError(cp->fd, FROM_ANON, sts);
+	    if (sts < 0)
+		pmNotifyErr(LOG_ERR, "HandleClientInput: "
+		    "error sending Error PDU to client[%d] %s\n", i, pmErrStr(sts));
 	}
-	if (pinpdu > 0)
-	    __pmUnpinPDUBuf(pb);
+    }
+    if (pinpdu > 0)
+	__pmUnpinPDUBuf(pb);
 
-	/*
-	 * May need to send connection attributes to interested PMDAs, if
-	 * something changed for this client during this PDU exchange.
-	 */
-	if (client[i].status.attributes) {
-	    if (pmDebugOptions.appl5)
-		fprintf(stderr, "Client idx=%d,seq=%d attrs reset\n",
-				i, client[i].seq);
-	    AgentsAttributes(i);
-	}
+    /*
+     * May need to send connection attributes to interested PMDAs, if
+     * something changed for this client during this PDU exchange.
+     */
+    if (client[i].status.attributes) {
+	if (pmDebugOptions.appl5)
+	    fprintf(stderr, "Client idx=%d,seq=%d attrs reset\n",
+			    i, client[i].seq);
+	AgentsAttributes(i);
     }
 }
 
@@ -676,72 +668,90 @@ SignalReloadPMNS(void)
     }
 }
 
-/* Process I/O on file descriptors from agents that were marked as not ready
- * to handle PDUs.
+/* Process I/O on the file descriptor from an agent that was marked as not
+ * ready to handle PDUs.
  */
 static int
-HandleReadyAgents(__pmFdSet *readyFds)
+HandleReadyAgent(AgentInfo *ap)
 {
-    int		i, s, sts;
-    int		fd;
+    int		s, sts;
+    int		fd = ap->outFd;
     int		reason;
     int		ready = 0;
-    AgentInfo	*ap;
+    int		pinpdu;
     __pmPDU	*pb;
 
+    /* Expect an error PDU containing PM_ERR_PMDAREADY */
+    reason = AT_COMM;	/* most errors are protocol failures */
+    pinpdu = sts = __pmGetPDU(ap->outFd, ANY_SIZE, pmcd_timeout, &pb);
+    if (sts > 0)
+	pmcd_trace(TR_RECV_PDU, ap->outFd, sts, (int)((__psint_t)pb & 0xffffffff));
+    if (sts == PDU_ERROR) {
+	s = __pmDecodeError(pb, &sts);
+	if (s < 0) {
+	    sts = s;
+	    pmcd_trace(TR_RECV_ERR, ap->outFd, PDU_ERROR, sts);
+	}
+	else {
+	    /* sts is the status code from the error PDU */
+	    if (pmDebugOptions.appl0)
+		pmNotifyErr(LOG_INFO,
+		     "%s agent (not ready) sent %s status(%d)\n",
+		     ap->pmDomainLabel,
+		     sts == PM_ERR_PMDAREADY ?
+				 "ready" : "unknown", sts);
+	    if (sts == PM_ERR_PMDAREADY) {
+		ap->status.notReady = 0;
+		sts = 1;
+		ready++;
+	    }
+	    else {
+		pmcd_trace(TR_RECV_ERR, ap->outFd, PDU_ERROR, sts);
+		sts = PM_ERR_IPC;
+	    }
+	}
+    }
+    else {
+	if (sts < 0)
+	    pmcd_trace(TR_RECV_ERR, ap->outFd, PDU_RESULT, sts);
+	else
+	    pmcd_trace(TR_WRONG_PDU, ap->outFd, PDU_ERROR, sts);
+	sts = PM_ERR_IPC; /* Wrong PDU type */
+    }
+    if (pinpdu > 0)
+	__pmUnpinPDUBuf(pb);
+
+    if (ap->ipcType != AGENT_DSO && sts <= 0)
+	CleanupAgent(ap, reason, fd);
+    return ready;
+}
+
+/* Watch for input only from those agents that are marked as not ready, so
+ * that the ERROR PDU indicating they are now ready can be received.
+ */
+static void
+WatchNotReadyAgents(void)
+{
+    int		i, fd, index;
+    AgentInfo	*ap;
+
     for (i = 0; i < nAgents; i++) {
 	ap = &agent[i];
+	fd = ap->outFd;
+	if (fd < 0)
+	    continue;
 	if (ap->status.notReady) {
-	    fd = ap->outFd;
-	    if (__pmFD_ISSET(fd, readyFds)) {
-		int		pinpdu;
-
-		/* Expect an error PDU containing PM_ERR_PMDAREADY */
-		reason = AT_COMM;	/* most errors are protocol failures */
-		pinpdu = sts = __pmGetPDU(ap->outFd, ANY_SIZE, pmcd_timeout, &pb);
-		if (sts > 0)
-		    pmcd_trace(TR_RECV_PDU, ap->outFd, sts, (int)((__psint_t)pb & 0xffffffff));
-		if (sts == PDU_ERROR) {
-		    s = __pmDecodeError(pb, &sts);
-		    if (s < 0) {
-			sts = s;
-			pmcd_trace(TR_RECV_ERR, ap->outFd, PDU_ERROR, sts);
-		    }
-		    else {
-			/* sts is the status code from the error PDU */
-			if (pmDebugOptions.appl0)
-			    pmNotifyErr(LOG_INFO,
-				 "%s agent (not ready) sent %s status(%d)\n",
-				 ap->pmDomainLabel,
-				 sts == PM_ERR_PMDAREADY ?
-					     "ready" : "unknown", sts);
-			if (sts == PM_ERR_PMDAREADY) {
-			    ap->status.notReady = 0;
-			    sts = 1;
-			    ready++;
-			}
-			else {
-			    pmcd_trace(TR_RECV_ERR, ap->outFd, PDU_ERROR, sts);
-			    sts = PM_ERR_IPC;
-			}
-		    }
-		}
-		else {
-		    if (sts < 0)
-			pmcd_trace(TR_RECV_ERR, ap->outFd, PDU_RESULT, sts);
-		    else
-			pmcd_trace(TR_WRONG_PDU, ap->outFd, PDU_ERROR, sts);
- 		    sts = PM_ERR_IPC; /* Wrong PDU type */
-		}
-		if (pinpdu > 0)
-		    __pmUnpinPDUBuf(pb);
-
-		if (ap->ipcType != AGENT_DSO && sts <= 0)
-		    CleanupAgent(ap, reason, fd);
-	    }
+	    if (IOEventType(fd, &index) == IO_AGENT && index == i)
+		continue;
+	    if (pmDebugOptions.appl0)
+		pmNotifyErr(LOG_INFO, "not ready: check %s agent on fd %d\n",
+			     ap->pmDomainLabel, fd);
+	    IOEventAdd(fd, IO_AGENT, i);
+	}
+	else if (IOEventType(fd, &index) == IO_AGENT && index == i) {
+	    IOEventDel(fd);
 	}
     }
-    return ready;
 }
 
 static void
@@ -833,54 +843,60 @@ static void
 ClientLoop(void)
 {
     int		i, fd, sts;
-    int		maxFd;
-    int		checkAgents;
+    int		newClients;
     int		reload_namespace = 0;
     int		restartAgents = -1;	/* initial state unknown */
-    __pmFdSet	readableFds;
+    __pmFdSet	requestFds;
+    IOEvent	*ready;
 
     for (;;) {
 
-	/* Figure out which file descriptors to wait for input on.  Keep
-	 * track of the highest numbered descriptor for the select call.
+	/* If an agent was not ready, it may send an ERROR PDU to indicate it
+	 * is now ready.  Add such agents to the watched file descriptors.
 	 */
-	readableFds = clientFds;
-	maxFd = maxClientFd + 1;
+	WatchNotReadyAgents();
 
-	/* If an agent was not ready, it may send an ERROR PDU to indicate it
-	 * is now ready.  Add such agents to the list of file descriptors.
+	/* Only the descriptors with input pending are returned, so the cost
+	 * of each pass here scales with activity, not with client count.
 	 */
-	checkAgents = 0;
-	for (i = 0; i < nAgents; i++) {
-	    AgentInfo	*ap = &agent[i];
-
-	    if (ap->status.notReady) {
-		fd = ap->outFd;
-		__pmFD_SET(fd, &readableFds);
-		if (fd > maxFd)
-		    maxFd = fd + 1;
-		checkAgents = 1;
+	sts = IOEventWait(&ready);
+	if (sts > 0) {
+	    __pmFD_ZERO(&requestFds);
+	    newClients = 0;
+	    for (i = 0; i < sts; i++) {
+		fd = ready[i].fd;
 		if (pmDebugOptions.appl0)
-		    pmNotifyErr(LOG_INFO,
-				 "not ready: check %s agent on fd %d (max = %d)\n",
-				 ap->pmDomainLabel, fd, maxFd);
+		    fprintf(stderr, "DATA: from %s (fd %d)\n",
+			    FdToString(fd), fd);
+		if (ready[i].type == IO_REQPORT) {
+		    __pmFD_SET(fd, &requestFds);
+		    newClients = 1;
+		}
+	    }
+	    if (newClients)
+		__pmServerAddNewClients(&requestFds, CheckNewClient);
+	    for (i = 0; i < sts; i++) {
+		AgentInfo	*ap;
+
+		if (ready[i].type != IO_AGENT)
+		    continue;
+		ap = &agent[ready[i].index];
+		if (ap->status.notReady && ap->outFd == ready[i].fd)
+		    reload_namespace |= HandleReadyAgent(ap);
+	    }
+	    for (i = 0; i < sts; i++) {
+		ClientInfo	*cp;
+
+		if (ready[i].type != IO_CLIENT)
+		    continue;
+		cp = &client[ready[i].index];
+		if (cp->status.connected && cp->fd == ready[i].fd)
+		    HandleClientInput(ready[i].index);
 	    }
-	}
-
-	sts = __pmSelectRead(maxFd, &readableFds, NULL);
-	if (sts > 0) {
-	    if (pmDebugOptions.appl0)
-		for (i = 0; i <= maxClientFd; i++)
-		    if (__pmFD_ISSET(i, &readableFds))
-			fprintf(stderr, "DATA: from %s (fd %d)\n",
-				FdToString(i), i);
-	    __pmServerAddNewClients(&readableFds, CheckNewClient);
-	    if (checkAgents)
-		reload_namespace = HandleReadyAgents(&readableFds);
-	    HandleClientInput(&readableFds);
 	}
 	else if (sts == -1 && neterror() != EINTR) {
-	    pmNotifyErr(LOG_ERR, "ClientLoop select: %s\n", netstrerror());
+	    pmNotifyErr(LOG_ERR, "ClientLoop %s: %s\n",
+			IOEventBackend(), netstrerror());
 	    break;
 	}
 	if (AgentDied) {
@@ -1004,12 +1020,13 @@ SigBad(int sig)
 int
 main(int argc, char *argv[])
 {
-    int		sts;
+    int		i, sts;
     int		nport = 0;
     int		localhost = 0;
     int		maxpending = MAXPENDING;
     int		env_warn = 0;
     char	*envstr;
+    __pmFdSet	requestFds;
 #ifdef HAVE_SA_SIGINFO
     static struct sigaction act;
 #endif
@@ -1099,9 +1116,15 @@ main(int argc, char *argv[])
     __pmSetSignalHandler(SIGBUS, SigBad);
     __pmSetSignalHandler(SIGSEGV, SigBad);
 
-    if ((sts = __pmServerOpenRequestPorts(&clientFds, maxpending)) < 0)
+    if (IOEventInit() < 0)
+	DontStart();
+    __pmFD_ZERO(&requestFds);
+    if ((sts = __pmServerOpenRequestPorts(&requestFds, maxpending)) < 0)
 	DontStart();
-    maxReqPortFd = maxClientFd = sts;
+    for (i = 0; i <= sts; i++) {
+	if (__pmFD_ISSET(i, &requestFds) && IOEventAdd(i, IO_REQPORT, 0) < 0)
+	    DontStart();
+    }
 
     /*
      * would prefer open log earlier so any messages up to this point
@@ -1291,9 +1314,6 @@ CleanupClient(ClientInfo *cp, int sts)
     pmcd_trace(TR_DEL_CLIENT, cp-client, cp->fd, sts);
     DeleteClient(cp);
 
-    if (maxClientFd < maxReqPortFd)
-	maxClientFd = maxReqPortFd;
-
     for (i = 0; i < nAgents; i++)
 	if (agent[i].profClient == cp)
 	    agent[i].profClient = NULL;
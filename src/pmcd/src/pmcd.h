@@ -71,6 +71,13 @@ typedef struct {
     pid_t agentPid;			/* Process ID of the agent */
 } PipeInfo;
 
+/*
+ * Per-agent fetch latency histogram, exported by the pmcd PMDA as
+ * pmcd.agent.fetch.latency.* ... bucket upper bounds are 100us, 1ms,
+ * 10ms, 100ms and 1sec, with the last bucket for anything slower.
+ */
+#define FETCH_BUCKETS	6
+
 /* The agent table and its size. */
 
 typedef struct {
@@ -102,6 +109,11 @@ typedef struct {
 	SocketInfo socket;
 	PipeInfo   pipe;
     } ipc;
+    struct {				/* Fetch latency statistics */
+	__uint64_t	count;		/* Completed fetch requests */
+	__uint64_t	time;		/* Total fetch latency (usec) */
+	__uint64_t	hist[FETCH_BUCKETS]; /* Latency histogram */
+    } fetch;
 } AgentInfo;
 
 PMCD_DATA extern AgentInfo	*agent;		/* Array of domain agent structs */
@@ -155,6 +167,14 @@ extern int	pmdarootfd;
 /* timeout to PMDAs (secs) */
 PMCD_DATA extern int	pmcd_timeout;
 
+/*
+ * window (msec) within which identical fetch requests are answered
+ * from one PMDA round trip, zero to disable, and its hit/miss counts
+ */
+PMCD_DATA extern int		pmcd_coalesce;
+PMCD_DATA extern __uint64_t	pmcd_coalesce_hits;
+PMCD_DATA extern __uint64_t	pmcd_coalesce_misses;
+
 /* timeout for credentials */
 extern int	_creds_timeout;
 
@@ -234,6 +254,26 @@ extern int ClientsAttributes(AgentInfo *);
 extern int AgentsAttributes(int);
 extern int CheckError(AgentInfo *, int);
 
+/*
+ * Readiness notification for ClientLoop (epoll or select backends)
+ */
+#define IO_REQPORT	1	/* request port, index is address family */
+#define IO_CLIENT	2	/* client, index into client[] */
+#define IO_AGENT	3	/* not-ready agent, index into agent[] */
+
+typedef struct {
+    int		fd;
+    int		type;		/* IO_* */
+    int		index;		/* as per type */
+} IOEvent;
+
+extern int IOEventInit(void);
+extern const char *IOEventBackend(void);
+extern int IOEventAdd(int, int, int);
+extern void IOEventDel(int);
+extern int IOEventType(int, int *);
+extern int IOEventWait(IOEvent **);
+
 /*
  * Highest known file descriptor used for a Client or an Agent connection.
  * This is reported in the pmcd.openfds metric.
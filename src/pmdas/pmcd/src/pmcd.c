@@ -205,6 +205,22 @@ static pmDesc	desctab[] = {
     { PMDA_PMID(4,2), PM_TYPE_U32, PM_INDOM_NULL, PM_SEM_INSTANT, PMDA_PMUNITS(0,0,0,0,0,0) },
 /* agent.name */
     { PMDA_PMID(4,3), PM_TYPE_STRING, PM_INDOM_NULL, PM_SEM_DISCRETE, PMDA_PMUNITS(0,0,0,0,0,0) },
+/* agent.fetch.count */
+    { PMDA_PMID(4,4), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER, PMDA_PMUNITS(0,0,1,0,0,PM_COUNT_ONE) },
+/* agent.fetch.time */
+    { PMDA_PMID(4,5), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER, PMDA_PMUNITS(0,1,0,0,PM_TIME_USEC,0) },
+/* agent.fetch.latency.under_100us */
+    { PMDA_PMID(4,6), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER, PMDA_PMUNITS(0,0,1,0,0,PM_COUNT_ONE) },
+/* agent.fetch.latency.under_1ms */
+    { PMDA_PMID(4,7), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER, PMDA_PMUNITS(0,0,1,0,0,PM_COUNT_ONE) },
+/* agent.fetch.latency.under_10ms */
+    { PMDA_PMID(4,8), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER, PMDA_PMUNITS(0,0,1,0,0,PM_COUNT_ONE) },
+/* agent.fetch.latency.under_100ms */
+    { PMDA_PMID(4,9), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER, PMDA_PMUNITS(0,0,1,0,0,PM_COUNT_ONE) },
+/* agent.fetch.latency.under_1sec */
+    { PMDA_PMID(4,10), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER, PMDA_PMUNITS(0,0,1,0,0,PM_COUNT_ONE) },
+/* agent.fetch.latency.over_1sec */
+    { PMDA_PMID(4,11), PM_TYPE_U64, PM_INDOM_NULL, PM_SEM_COUNTER, PMDA_PMUNITS(0,0,1,0,0,PM_COUNT_ONE) },
 
 /* pmie.configfile */
     { PMDA_PMID(5,0), PM_TYPE_STRING, PM_INDOM_NULL, PM_SEM_DISCRETE, PMDA_PMUNITS(0,0,0,0,0,0) },
@@ -1684,6 +1700,20 @@ pmcd_fetch(int numpmid, pmID pmidlist[], pmResult **resp, pmdaExt *pmda)
 			case 3:		/* agent.name */
 			    atom.cp = agent[j].pmDomainLabel;
 			    break;
+			case 4:		/* agent.fetch.count */
+			    atom.ull = agent[j].fetch.count;
+			    break;
+			case 5:		/* agent.fetch.time */
+			    atom.ull = agent[j].fetch.time;
+			    break;
+			case 6:		/* agent.fetch.latency.under_100us */
+			case 7:		/* agent.fetch.latency.under_1ms */
+			case 8:		/* agent.fetch.latency.under_10ms */
+			case 9:		/* agent.fetch.latency.under_100ms */
+			case 10:	/* agent.fetch.latency.under_1sec */
+			case 11:	/* agent.fetch.latency.over_1sec */
+			    atom.ull = agent[j].fetch.hist[item - 6];
+			    break;
 			default:
 			    sts = atom.l = PM_ERR_PMID;
 			    break;